@@ -10,7 +10,10 @@
 #include "rp/shape.hpp"
 #include "rp/rectangle.hpp"
 #include "rp/grid.hpp"
+#include "rp/fixed_name_generator.hpp"
 #include "rp/rect_generator.hpp"
+#include "rp/rect_loader.hpp"
+#include "rp/grid_exporter.hpp"
 
 static inline void clearScreen() {
     #if defined(__linux__) || defined(__CYGWIN__)
@@ -33,7 +36,7 @@ static inline void promptForEnterKeyAndAdvanceLine() {
 static void printRectangles(RP::Grid<int>& grid) {
     std::cout << "Rectangles currently present in grid\n------------------------------\n";
     grid.forEach([](const RP::Rectangle<int>& r) {
-       std::cout << "\"" << r.name << "\" - " << r.bottomLeft.toString() << " - " << r.topRight.toString() << std::endl;
+       std::cout << "\"" << r.name << "\" - " << r.bottomLeft.toString() << " - " << r.topRight.toString() << '\n';
     });
     std::cout << "------------------------------\n";
 }
@@ -311,21 +314,12 @@ RP::Vector2<int> stringToPoint(const std::string& str) {
     }
 }
 
-static inline bool validRectName(const std::string& name) {
-    for (const auto& c : name) {
-        if (!std::islower(c, {})) {
-            return false;
-        }
-    }
-    return true;
-}
-
 static RP::Rectangle<int> parseRectString(const std::string& str) {
     std::vector<std::string> splitString = stringSplit(str, ';');
     if (splitString.size() != 3) {
         throw IllegalFormatError();
     }
-    if (splitString.at(0).size() != 4 || !validRectName(splitString.at(0))) {
+    if (!RP::RectNameGenerator::isValid(splitString.at(0))) {
         throw IllegalFormatError();
     }
     RP::Vector2<int> bottomLeft = stringToPoint(splitString.at(1));
@@ -334,31 +328,30 @@ static RP::Rectangle<int> parseRectString(const std::string& str) {
     return { std::move(bottomLeft), std::move(topRight), std::move(splitString.at(0)) };
 }
 
-static std::vector<RP::Rectangle<int>> readRectanglesFromStream(std::istream& in) {
-    std::vector<RP::Rectangle<int>> rectangles;
-    for (std::string input; std::getline(in, input, '\n');) {
+static void readRectanglesFromStreamToGrid(std::istream&& in, RP::Grid<int>& grid) {
+    const RP::RectLoader<int> loader([](const std::string& line) -> std::experimental::optional<RP::Rectangle<int>> {
         try {
-            rectangles.push_back(parseRectString(input));
+            return parseRectString(line);
         } catch (const IllegalFormatError& e) {
-            std::cout << "Line " << input << " ignored due to illegal format." << std::endl;
+            return {};
         }
-    }
-    return rectangles;
-}
-
-static void readRectanglesFromStreamToGrid(std::istream&& in, RP::Grid<int>& grid) {
-    std::vector<RP::Rectangle<int>> rectangles = readRectanglesFromStream(in);
+    });
 
-    for (const auto& rect : rectangles) {
+    loader.load(in, [&grid](RP::ParsedLine<int>&& parsed) {
+        if (!parsed.rect) {
+            std::cout << "Line " << parsed.line << " ignored due to illegal format." << std::endl;
+            return;
+        }
+        const auto& rect = *parsed.rect;
         try {
-            grid.addRectangle(std::move(rect));
+            grid.addRectangle(RP::Rectangle<int> {rect});
         } catch (const RP::IllegalNameError& e) {
             std::cout << "Rectangle " << rect.toString() << " was ignored due to a name conflict." << std::endl;
 
         } catch (const RP::IllegalSizeError& e) {
             std::cout << "Rectangle " << rect.toString() << " was ignored because it has illegal size:\n" << e.what << std::endl;
         }
-    }
+    });
 }
 
 static void readRectanglesFromUserFile(RP::Grid<int>& grid) {
@@ -377,6 +370,27 @@ static void readRectanglesFromUserFile(RP::Grid<int>& grid) {
     }
 }
 
+static void writeRectanglesToUserFile(const RP::Grid<int>& grid) {
+    while (true) {
+        std::string input;
+        std::cout << "Please enter a valid file name: ";
+        std::cin >> input;
+        std::ofstream file(input, std::ios::binary);
+        if (!file) {
+            std::cout << "File name \"" << input << "\" invalid: File could not be opened for writing." << std::endl;
+        }
+        else {
+            RP::GridExporter<int>(RP::ExportFormat::Text).exportGrid(grid, file);
+            if (!file) {
+                std::cout << "Failed to write rectangles to \"" << input << "\"." << std::endl;
+                break;
+            }
+            std::cout << "Saved " << grid.size() << " rectangles to \"" << input << "\"." << std::endl;
+            break;
+        }
+    }
+}
+
 int main() {
     srand(time(nullptr));
     RP::Grid<int> grid{600, 400};
@@ -393,11 +407,12 @@ int main() {
                   << "6. Sort rectangles by name\n"
                   << "7. Check if point in rectangle\n"
                   << "8. Load rectangles from file name\n"
-                  << "9. Quit\n";
+                  << "9. Save rectangles to file name\n"
+                  << "10. Quit\n";
         std::cout << "Enter an option: ";
         int input;
         if (!(std::cin >> input)) {
-            std::cout << "Illegal input: must be a number between 1 and 9." << std::endl;
+            std::cout << "Illegal input: must be a number between 1 and 10." << std::endl;
             std::cin.clear();
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
         } else {
@@ -427,10 +442,13 @@ int main() {
                     readRectanglesFromUserFile(grid);
                     break;
                 case 9:
+                    writeRectanglesToUserFile(grid);
+                    break;
+                case 10:
                     std::cout << "Goodbye.";
                     return 0;
                 default:
-                    std::cout << "Illegal option '" << input << "': Must be between 1 and 9." << std::endl;
+                    std::cout << "Illegal option '" << input << "': Must be between 1 and 10." << std::endl;
                     break;
             }
         }
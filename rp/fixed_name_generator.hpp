@@ -0,0 +1,113 @@
+#ifndef DT1_FIXED_NAME_GENERATOR_H
+#define DT1_FIXED_NAME_GENERATOR_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace RP {
+    /*
+    * Generates and validates names of exactly Length characters drawn from the contiguous range [First, Last].
+    * Both directions work a 64-bit word at a time and never allocate.
+    */
+    template <std::size_t Length, char First, char Last>
+    class FixedNameGenerator {
+        static_assert(Length > 0, "Names must have at least one character");
+        static_assert(First <= Last, "Alphabet range must not be empty");
+        static_assert(First >= 0 && Last < 0x7F, "Alphabet must be 7-bit ASCII");
+
+        static constexpr std::uint64_t alphabetSize = static_cast<std::uint64_t>(Last - First + 1);
+
+        static constexpr std::size_t charactersPerWord() {
+            std::size_t count = 0;
+            for (std::uint64_t span = 1; span <= std::numeric_limits<std::uint64_t>::max() / alphabetSize; span *= alphabetSize) {
+                count++;
+            }
+            return count;
+        }
+
+        static constexpr std::uint64_t wordSpan() {
+            std::uint64_t span = 1;
+            for (std::size_t i = 0; i < charactersPerWord(); i++) {
+                span *= alphabetSize;
+            }
+            return span;
+        }
+
+        static constexpr std::uint64_t byteMask(const unsigned char byte) {
+            return 0x0101010101010101ULL * byte;
+        }
+
+        std::mt19937_64 engine;
+
+    public:
+        typedef std::array<char, Length> Name;
+
+        explicit FixedNameGenerator(const std::uint64_t seed) : engine(seed) {}
+
+        Name generateName() {
+            Name name;
+            // Words at or above the largest multiple of wordSpan are redrawn so every character stays uniform
+            constexpr std::uint64_t limit = std::numeric_limits<std::uint64_t>::max() / wordSpan() * wordSpan();
+            for (std::size_t i = 0; i < Length;) {
+                std::uint64_t word;
+                do {
+                    word = engine();
+                } while (word >= limit);
+                for (std::size_t j = 0; j < charactersPerWord() && i < Length; j++, i++) {
+                    name[i] = static_cast<char>(First + word % alphabetSize);
+                    word /= alphabetSize;
+                }
+            }
+            return name;
+        }
+
+        static bool isValid(const char* name, const std::size_t length) noexcept {
+            if (length != Length) {
+                return false;
+            }
+            std::size_t i = 0;
+            for (; i + sizeof(std::uint64_t) <= Length; i += sizeof(std::uint64_t)) {
+                std::uint64_t word;
+                std::memcpy(&word, name + i, sizeof(word));
+                if (!isValidWord(word)) {
+                    return false;
+                }
+            }
+            if (i < Length) {
+                // Pad the tail with a character that always passes
+                char tail[sizeof(std::uint64_t)];
+                std::memset(tail, First, sizeof(tail));
+                std::memcpy(tail, name + i, Length - i);
+                std::uint64_t word;
+                std::memcpy(&word, tail, sizeof(word));
+                return isValidWord(word);
+            }
+            return true;
+        }
+
+        static bool isValid(const std::string& name) noexcept {
+            return isValid(name.data(), name.size());
+        }
+
+    private:
+        /*
+        * Every byte must have its high bit clear, not exceed Last once biased towards 0x80, and still have
+        * its high bit set after subtracting First from it with the high bit forced on. No step carries or
+        * borrows between bytes, so all eight are checked with a handful of instructions.
+        */
+        static bool isValidWord(const std::uint64_t word) noexcept {
+            const std::uint64_t high = byteMask(0x80);
+            const std::uint64_t aboveLast = word + byteMask(static_cast<unsigned char>(0x7F - Last));
+            const std::uint64_t atLeastFirst = (word | high) - byteMask(static_cast<unsigned char>(First));
+            return ((word | aboveLast | ~atLeastFirst) & high) == 0;
+        }
+    };
+
+    typedef FixedNameGenerator<4, 'a', 'z'> RectNameGenerator;
+}
+
+#endif //DT1_FIXED_NAME_GENERATOR_H
@@ -0,0 +1,151 @@
+#ifndef DT1_GRID_EXPORTER_H
+#define DT1_GRID_EXPORTER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "grid.hpp"
+
+namespace RP {
+    enum class ExportFormat {
+        // One "name;(x, y);(x, y)" line per rectangle, as read back by the file loader
+        Text,
+        // A header row followed by one "name",x,y,x,y row per rectangle
+        Csv,
+        // Per rectangle: name length as uint32_t, the name bytes, then the four coordinates, all in native byte order
+        Binary
+    };
+
+    /*
+    * Writes a grid in bulk. Rectangles are formatted in chunks into reusable buffers, optionally on several
+    * threads at once, and every chunk reaches the stream with a single write call, in grid order.
+    */
+    template <typename T>
+    class GridExporter {
+    public:
+        GridExporter(const ExportFormat format, const std::size_t chunkSize = 4096,
+                     const unsigned threads = std::max(1u, std::thread::hardware_concurrency()))
+                : format(format), chunkSize(std::max<std::size_t>(1, chunkSize)), threads(std::max(1u, threads)), buffers(this -> threads) {}
+
+        void exportGrid(const Grid<T>& grid, std::ostream& out) {
+            std::vector<const Rectangle<T>*> rects;
+            rects.reserve(grid.size());
+            grid.forEach([&rects](const Rectangle<T>& r) {
+                rects.push_back(&r);
+            });
+
+            if (format == ExportFormat::Csv) {
+                static const char header[] = "name,bottomLeftX,bottomLeftY,topRightX,topRightY\n";
+                out.write(header, sizeof(header) - 1);
+            }
+
+            const std::size_t chunks = (rects.size() + chunkSize - 1) / chunkSize;
+            for (std::size_t first = 0; first < chunks; first += threads) {
+                const std::size_t batch = std::min<std::size_t>(threads, chunks - first);
+                if (batch == 1) {
+                    formatChunk(rects, first, buffers[0]);
+                } else {
+                    std::vector<std::thread> workers;
+                    for (std::size_t i = 0; i < batch; i++) {
+                        workers.emplace_back([this, &rects, first, i]() {
+                            formatChunk(rects, first + i, buffers[i]);
+                        });
+                    }
+                    for (auto& worker : workers) {
+                        worker.join();
+                    }
+                }
+                for (std::size_t i = 0; i < batch; i++) {
+                    out.write(buffers[i].data(), buffers[i].size());
+                }
+            }
+            out.flush();
+        }
+
+    private:
+        void formatChunk(const std::vector<const Rectangle<T>*>& rects, const std::size_t chunk, std::string& buffer) const {
+            buffer.clear();
+            const std::size_t end = std::min(rects.size(), (chunk + 1) * chunkSize);
+            for (std::size_t i = chunk * chunkSize; i < end; i++) {
+                const Rectangle<T>& r = *rects[i];
+                switch (format) {
+                    case ExportFormat::Text:
+                        buffer += r.name;
+                        buffer += ";(";
+                        appendInteger(buffer, r.bottomLeft.x);
+                        buffer += ", ";
+                        appendInteger(buffer, r.bottomLeft.y);
+                        buffer += ");(";
+                        appendInteger(buffer, r.topRight.x);
+                        buffer += ", ";
+                        appendInteger(buffer, r.topRight.y);
+                        buffer += ")\n";
+                        break;
+                    case ExportFormat::Csv:
+                        buffer += '"';
+                        for (const auto& c : r.name) {
+                            if (c == '"') {
+                                buffer += '"';
+                            }
+                            buffer += c;
+                        }
+                        buffer += "\",";
+                        appendInteger(buffer, r.bottomLeft.x);
+                        buffer += ',';
+                        appendInteger(buffer, r.bottomLeft.y);
+                        buffer += ',';
+                        appendInteger(buffer, r.topRight.x);
+                        buffer += ',';
+                        appendInteger(buffer, r.topRight.y);
+                        buffer += '\n';
+                        break;
+                    case ExportFormat::Binary:
+                        appendRaw(buffer, static_cast<std::uint32_t>(r.name.size()));
+                        buffer += r.name;
+                        appendRaw(buffer, r.bottomLeft.x);
+                        appendRaw(buffer, r.bottomLeft.y);
+                        appendRaw(buffer, r.topRight.x);
+                        appendRaw(buffer, r.topRight.y);
+                        break;
+                }
+            }
+        }
+
+        /*
+        * Formats without going through a temporary string or the stream's locale machinery.
+        */
+        static void appendInteger(std::string& buffer, const T value) {
+            typedef typename std::make_unsigned<T>::type U;
+            char digits[std::numeric_limits<U>::digits10 + 2];
+            char* p = digits + sizeof(digits);
+            // Negating in the unsigned type keeps the minimum value well defined
+            U magnitude = value < 0 ? static_cast<U>(0) - static_cast<U>(value) : static_cast<U>(value);
+            do {
+                *--p = static_cast<char>('0' + magnitude % 10);
+                magnitude /= 10;
+            } while (magnitude);
+            if (value < 0) {
+                buffer += '-';
+            }
+            buffer.append(p, digits + sizeof(digits));
+        }
+
+        template <typename V>
+        static void appendRaw(std::string& buffer, const V value) {
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        const ExportFormat format;
+        const std::size_t chunkSize;
+        const unsigned threads;
+
+        std::vector<std::string> buffers;
+    };
+}
+
+#endif //DT1_GRID_EXPORTER_H
@@ -16,6 +16,10 @@ namespace RP {
     struct IllegalSizeError {
         const std::string what;
     };
+
+    struct ShardStateError {
+        const std::string what;
+    };
 }
 
 #endif //DT1_EXCEPTIONS_H
@@ -1,16 +0,0 @@
-#ifndef NAME_GENERATOR
-#define NAME_GENERATOR
-#include <string>
-#include <functional>
-
-namespace RP {
-    class NameGenerator {
-        std::function<char ()> charProvider;
-        size_t len;
-    public:
-        NameGenerator(const std::function<char ()>& charProvider, size_t len);
-        virtual std::string generateName();
-    };    
-}
-
-#endif
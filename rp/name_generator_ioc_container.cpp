@@ -1,3 +1,4 @@
+#include <cstdlib>
 #include "name_generator_ioc_container.hpp"
 
 namespace RP {
@@ -6,8 +7,8 @@ namespace RP {
     NameGeneratorIOC& NameGeneratorIOC::getInstance() noexcept {
         return instance;
     }
-    NameGenerator NameGeneratorIOC::constructNameGenerator() const {
-        auto charProvider = [] ()->char { return static_cast<char>( rand() % ('z' - 'a' + 1) + 'a' ); };
-        return NameGenerator(charProvider, 4);
+    RectNameGenerator NameGeneratorIOC::constructNameGenerator() const {
+        // Seeded from rand() so srand() still decides which names get generated
+        return RectNameGenerator(static_cast<std::uint64_t>(rand()) << 32 ^ static_cast<std::uint64_t>(rand()));
     }
 }
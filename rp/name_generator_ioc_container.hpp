@@ -1,6 +1,6 @@
 #ifndef NAME_GENERATOR_IOC
 #define NAME_GENERATOR_IOC
-#include "name_generator.hpp"
+#include "fixed_name_generator.hpp"
 
 namespace RP {
     class NameGeneratorIOC {
@@ -8,7 +8,7 @@ namespace RP {
         NameGeneratorIOC();
     public:
         static NameGeneratorIOC& getInstance() noexcept;
-        NameGenerator constructNameGenerator() const;
+        RectNameGenerator constructNameGenerator() const;
     };
 }
 
@@ -5,14 +5,15 @@
 namespace RP {
     template <class T>
     class RectGenerator {
-        NameGenerator nameGenerator;
+        RectNameGenerator nameGenerator;
     public:
         RectGenerator() : nameGenerator(NameGeneratorIOC::getInstance().constructNameGenerator()) {}
 
         void addRandomRectangleToGrid(Grid<T>& grid) {
             std::string name;
             while (true) {
-                name = nameGenerator.generateName();
+                const auto generated = nameGenerator.generateName();
+                name.assign(generated.data(), generated.size());
                 bool nameAvailable = !grid.findRectangleByName(name);
                 if (nameAvailable) {
                     break;
@@ -0,0 +1,100 @@
+#ifndef DT1_RECT_LOADER_H
+#define DT1_RECT_LOADER_H
+
+#include <exception>
+#include <functional>
+#include <istream>
+#include <string>
+#include <thread>
+#include "rectangle.hpp"
+#include "spsc_queue.hpp"
+
+namespace RP {
+    template <typename T>
+    struct ParsedLine {
+        std::string line;
+        std::experimental::optional<Rectangle<T>> rect;
+    };
+
+    /*
+    * Loads rectangles through a three stage pipeline: a reader thread splits the stream into lines,
+    * a parser thread turns lines into rectangles, and the calling thread inserts them as they arrive.
+    * The stages are connected by bounded queues, so memory stays constant regardless of stream length.
+    */
+    template <typename T>
+    class RectLoader {
+    public:
+        typedef std::function<std::experimental::optional<Rectangle<T>> (const std::string&)> Parser;
+        typedef std::function<void (ParsedLine<T>&&)> Inserter;
+
+        RectLoader(const Parser parser, const std::size_t queueCapacity = 1024) : parser(parser), queueCapacity(queueCapacity) {}
+
+        /*
+        * Lines the parser rejects reach the inserter with an empty rect. Exceptions thrown by any stage
+        * are rethrown here once the pipeline has shut down; a reader blocked on input is waited for.
+        */
+        void load(std::istream& in, const Inserter inserter) const {
+            SpscQueue<std::string> lines(queueCapacity);
+            SpscQueue<ParsedLine<T>> parsed(queueCapacity);
+            std::exception_ptr readError, parseError;
+
+            const auto cancel = [&]() {
+                lines.cancel();
+                parsed.cancel();
+            };
+
+            std::thread reader([&]() {
+                try {
+                    for (std::string line; std::getline(in, line, '\n');) {
+                        if (!lines.push(std::move(line))) {
+                            break;
+                        }
+                    }
+                } catch (...) {
+                    readError = std::current_exception();
+                    cancel();
+                }
+                lines.close();
+            });
+
+            std::thread parserThread([&]() {
+                try {
+                    while (lines.pop([&](std::string&& line) {
+                        auto rect = parser(line);
+                        parsed.push({std::move(line), std::move(rect)});
+                    }));
+                } catch (...) {
+                    parseError = std::current_exception();
+                    cancel();
+                }
+                parsed.close();
+            });
+
+            try {
+                while (parsed.pop([&](ParsedLine<T>&& result) {
+                    inserter(std::move(result));
+                }));
+            } catch (...) {
+                cancel();
+                reader.join();
+                parserThread.join();
+                throw;
+            }
+            reader.join();
+            parserThread.join();
+
+            if (readError) {
+                std::rethrow_exception(readError);
+            }
+            if (parseError) {
+                std::rethrow_exception(parseError);
+            }
+        }
+
+    private:
+        const Parser parser;
+        const std::size_t queueCapacity;
+    };
+}
+
+#endif //DT1_RECT_LOADER_H
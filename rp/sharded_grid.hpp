@@ -0,0 +1,341 @@
+#ifndef DT1_SHARDED_GRID_H
+#define DT1_SHARDED_GRID_H
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "grid.hpp"
+
+namespace RP {
+    /*
+    * Splits a grid's extent into fixed-size tiles, each backed by its own Grid.
+    * A rectangle is stored in every tile it overlaps, and queries only lock the tiles they touch.
+    * Tiles can be unloaded through a ShardWriter and are restored on demand through a ShardReader.
+    * Updates only hold the name directory's lock long enough to reserve or release a name.
+    */
+    template <typename T>
+    class ShardedGrid {
+    public:
+        typedef typename Grid<T>::size_type size_type;
+        typedef std::function<void (size_type shard, const Grid<T>& grid)> ShardWriter;
+        typedef std::function<void (size_type shard, Grid<T>& grid)> ShardReader;
+
+        enum class ScanMode {
+            // Unloaded shards are read into a temporary Grid that is dropped once the shard has been visited
+            ReleaseReloaded,
+            // Unloaded shards are loaded back in and stay resident until unloadShard is called again
+            KeepLoaded
+        };
+
+        ShardedGrid(const T height, const T width, const T tileHeight, const T tileWidth,
+                    const ShardWriter writer = nullptr, const ShardReader reader = nullptr)
+                : height(height), width(width), tileHeight(tileHeight), tileWidth(tileWidth),
+                  columns(tileCount(width, tileWidth)), rows(tileCount(height, tileHeight)),
+                  writer(writer), reader(reader), shards(columns * rows), directory({}), visibleCount(0) {
+            for (auto& shard : shards) {
+                shard.grid.reset(new Grid<T>{height, width});
+            }
+        }
+
+        const size_type size() const noexcept {
+            std::lock_guard<std::mutex> lock(directoryMutex);
+            return visibleCount;
+        }
+
+        const size_type shardCount() const noexcept {
+            return shards.size();
+        }
+
+        /*
+        * Visits every rectangle once, from the tile holding its lower left corner.
+        */
+        void forEach(const std::function<void (const Rectangle<T>&)> consumer, const ScanMode mode = ScanMode::ReleaseReloaded) const {
+            for (size_type i = 0; i < shards.size(); i++) {
+                visit(i, mode, [&](const Grid<T>& grid) {
+                    grid.forEach([&](const Rectangle<T>& r) {
+                        if (shardIndex(column(r.bottomLeft.x), row(r.bottomLeft.y)) == i) {
+                            consumer(r);
+                        }
+                    });
+                });
+            }
+        }
+
+        void forEachContainingPoint(const Vector2<T>& point, const std::function<void (const Rectangle<T>&)> consumer,
+                                    const ScanMode mode = ScanMode::ReleaseReloaded) const {
+            visit(shardIndex(column(point.x), row(point.y)), mode, [&](const Grid<T>& grid) {
+                grid.forEach([&](const Rectangle<T>& r) {
+                    if (r.containsPoint(point)) {
+                        consumer(r);
+                    }
+                });
+            });
+        }
+
+        /*
+        * Visits every rectangle overlapping the given region once, from the first tile both of them share.
+        */
+        void forEachIntersecting(const Rectangle<T>& region, const std::function<void (const Rectangle<T>&)> consumer,
+                                 const ScanMode mode = ScanMode::ReleaseReloaded) const {
+            const Span query = spanOf(region);
+            for (size_type r = query.minRow; r <= query.maxRow; r++) {
+                for (size_type c = query.minColumn; c <= query.maxColumn; c++) {
+                    visit(shardIndex(c, r), mode, [&](const Grid<T>& grid) {
+                        grid.forEach([&](const Rectangle<T>& rect) {
+                            if (!overlaps(rect, region)) {
+                                return;
+                            }
+                            const Span owner = spanOf(rect);
+                            if (std::max(owner.minColumn, query.minColumn) == c && std::max(owner.minRow, query.minRow) == r) {
+                                consumer(rect);
+                            }
+                        });
+                    });
+                }
+            }
+        }
+
+        /*
+        * The name is reserved first, so it stays taken but invisible while the rectangle is replicated.
+        * If any tile rejects it, the copies already made are removed again and the reservation is released.
+        */
+        void addRectangle(const Rectangle<T>&& rect) {
+            const Span span = spanOf(rect);
+            {
+                std::lock_guard<std::mutex> directoryLock(directoryMutex);
+                if (!directory.insert({rect.name, {span, false}}).second) {
+                    throw IllegalNameError {"A rectangle named " + rect.name + " already exists in this grid"};
+                }
+            }
+            std::vector<size_type> inserted;
+            try {
+                // The home tile comes first, so its Grid rejects an illegal size before anything is replicated
+                forEachShardIn(span, [&](const size_type i) {
+                    acquire(i).addRectangle(Rectangle<T>{rect});
+                    inserted.push_back(i);
+                });
+            } catch (...) {
+                for (const auto i : inserted) {
+                    std::lock_guard<std::mutex> lock(shards[i].mutex);
+                    try {
+                        acquire(i).removeRectangleByName(rect.name);
+                    } catch (...) {
+                        // The shard was unloaded meanwhile and cannot be read back; the original error matters more
+                    }
+                }
+                std::lock_guard<std::mutex> directoryLock(directoryMutex);
+                directory.erase(rect.name);
+                throw;
+            }
+            std::lock_guard<std::mutex> directoryLock(directoryMutex);
+            directory[rect.name].visible = true;
+            visibleCount++;
+        }
+
+        /*
+        * The name is hidden before its copies are removed and only released afterwards, so it cannot be re-added in between.
+        * If a shard cannot be read back the rectangle becomes visible again, and the removal can simply be retried.
+        */
+        const bool removeRectangleByName(const std::string& name) {
+            Span span;
+            {
+                std::lock_guard<std::mutex> directoryLock(directoryMutex);
+                const auto lookup = directory.find(name);
+                if (lookup == directory.end() || !lookup -> second.visible) {
+                    return false;
+                }
+                lookup -> second.visible = false;
+                visibleCount--;
+                span = lookup -> second.span;
+            }
+            try {
+                forEachShardIn(span, [&](const size_type i) {
+                    acquire(i).removeRectangleByName(name);
+                });
+            } catch (...) {
+                std::lock_guard<std::mutex> directoryLock(directoryMutex);
+                directory[name].visible = true;
+                visibleCount++;
+                throw;
+            }
+            std::lock_guard<std::mutex> directoryLock(directoryMutex);
+            directory.erase(name);
+            return true;
+        }
+
+        /*
+        * Loads the rectangle's home shard if needed and keeps it resident.
+        */
+        const std::experimental::optional<Rectangle<T>> findRectangleByName(const std::string& name) const {
+            size_type home;
+            {
+                std::lock_guard<std::mutex> directoryLock(directoryMutex);
+                const auto lookup = directory.find(name);
+                if (lookup == directory.end() || !lookup -> second.visible) {
+                    return {};
+                }
+                home = shardIndex(lookup -> second.span.minColumn, lookup -> second.span.minRow);
+            }
+            std::lock_guard<std::mutex> lock(shards[home].mutex);
+            return acquire(home).findRectangleByName(name);
+        }
+
+        const bool isShardLoaded(const size_type shard) const {
+            checkShardIndex(shard);
+            std::lock_guard<std::mutex> lock(shards[shard].mutex);
+            return static_cast<bool>(shards[shard].grid);
+        }
+
+        void loadShard(const size_type shard) const {
+            checkShardIndex(shard);
+            std::lock_guard<std::mutex> lock(shards[shard].mutex);
+            acquire(shard);
+        }
+
+        void persistShard(const size_type shard) const {
+            checkShardIndex(shard);
+            std::lock_guard<std::mutex> lock(shards[shard].mutex);
+            if (!writer) {
+                throw ShardStateError {"Shard " + std::to_string(shard) + " cannot be persisted without a shard writer"};
+            }
+            if (shards[shard].grid) {
+                writer(shard, *shards[shard].grid);
+            }
+        }
+
+        /*
+        * Persists the shard through the writer and releases its memory. No-op if it is already unloaded.
+        */
+        void unloadShard(const size_type shard) {
+            checkShardIndex(shard);
+            std::lock_guard<std::mutex> lock(shards[shard].mutex);
+            if (!writer || !reader) {
+                throw ShardStateError {"Shard " + std::to_string(shard) + " cannot be unloaded without a shard writer and reader"};
+            }
+            if (shards[shard].grid) {
+                writer(shard, *shards[shard].grid);
+                shards[shard].grid.reset();
+            }
+        }
+
+        T getHeight() const noexcept {
+            return height;
+        }
+
+        T getWidth() const noexcept {
+            return width;
+        }
+
+        T getTileHeight() const noexcept {
+            return tileHeight;
+        }
+
+        T getTileWidth() const noexcept {
+            return tileWidth;
+        }
+
+    private:
+        struct Shard {
+            mutable std::unique_ptr<Grid<T>> grid;
+            mutable std::mutex mutex;
+        };
+
+        struct Span {
+            size_type minColumn, minRow, maxColumn, maxRow;
+        };
+
+        struct DirectoryEntry {
+            Span span;
+            bool visible;
+        };
+
+        static size_type tileCount(const T extent, const T tile) {
+            if (tile <= 0) {
+                throw IllegalSizeError {"Tile size " + std::to_string(tile) + " must be positive"};
+            }
+            return static_cast<size_type>(std::max<T>(1, (extent + tile - 1) / tile));
+        }
+
+        static const bool overlaps(const Rectangle<T>& a, const Rectangle<T>& b) noexcept {
+            return a.bottomLeft.x <= b.topRight.x && b.bottomLeft.x <= a.topRight.x
+                && a.bottomLeft.y <= b.topRight.y && b.bottomLeft.y <= a.topRight.y;
+        }
+
+        size_type column(const T x) const noexcept {
+            return x <= 0 ? 0 : std::min(static_cast<size_type>(x / tileWidth), columns - 1);
+        }
+
+        size_type row(const T y) const noexcept {
+            return y <= 0 ? 0 : std::min(static_cast<size_type>(y / tileHeight), rows - 1);
+        }
+
+        size_type shardIndex(const size_type column, const size_type row) const noexcept {
+            return row * columns + column;
+        }
+
+        Span spanOf(const Rectangle<T>& rect) const noexcept {
+            const size_type minColumn = column(rect.bottomLeft.x), minRow = row(rect.bottomLeft.y);
+            return {minColumn, minRow, std::max(minColumn, column(rect.topRight.x)), std::max(minRow, row(rect.topRight.y))};
+        }
+
+        void checkShardIndex(const size_type shard) const {
+            if (shard >= shards.size()) {
+                throw ShardStateError {"Shard " + std::to_string(shard) + " does not exist in this grid"};
+            }
+        }
+
+        /*
+        * Visits the shards of a span in ascending index order, holding one shard lock at a time.
+        */
+        void forEachShardIn(const Span& span, const std::function<void (const size_type)> action) const {
+            for (size_type r = span.minRow; r <= span.maxRow; r++) {
+                for (size_type c = span.minColumn; c <= span.maxColumn; c++) {
+                    const size_type i = shardIndex(c, r);
+                    std::lock_guard<std::mutex> lock(shards[i].mutex);
+                    action(i);
+                }
+            }
+        }
+
+        /*
+        * Must be called with the shard's mutex held. A reader that throws leaves the shard unloaded.
+        */
+        Grid<T>& acquire(const size_type shard) const {
+            auto& grid = shards[shard].grid;
+            if (!grid) {
+                std::unique_ptr<Grid<T>> loaded(new Grid<T>{height, width});
+                reader(shard, *loaded);
+                grid = std::move(loaded);
+            }
+            return *grid;
+        }
+
+        void visit(const size_type shard, const ScanMode mode, const std::function<void (const Grid<T>&)> action) const {
+            std::lock_guard<std::mutex> lock(shards[shard].mutex);
+            if (shards[shard].grid || mode == ScanMode::KeepLoaded) {
+                action(acquire(shard));
+            } else {
+                Grid<T> transient{height, width};
+                reader(shard, transient);
+                action(transient);
+            }
+        }
+
+        const T height, width, tileHeight, tileWidth;
+        const size_type columns, rows;
+
+        const ShardWriter writer;
+        const ShardReader reader;
+
+        std::vector<Shard> shards;
+
+        mutable std::mutex directoryMutex;
+        std::map<std::string, DirectoryEntry> directory;
+        size_type visibleCount;
+    };
+}
+
+#endif //DT1_SHARDED_GRID_H
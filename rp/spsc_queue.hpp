@@ -0,0 +1,168 @@
+#ifndef DT1_SPSC_QUEUE_H
+#define DT1_SPSC_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include "gridexceptions.hpp"
+
+namespace RP {
+    /*
+    * Bounded lock-free ring buffer for exactly one producer thread and one consumer thread.
+    * push blocks while the queue is full, which gives backpressure to the producer.
+    * A side that has to wait spins briefly, then parks on a condition variable until the other side wakes it.
+    */
+    template <typename T>
+    class SpscQueue {
+    public:
+        explicit SpscQueue(const std::size_t capacity)
+                : slotCount(checkCapacity(capacity) + 1), slots(new Slot[capacity + 1]), head(0), tail(0),
+                  closed(false), cancelled(false), producerParked(false), consumerParked(false) {}
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        ~SpscQueue() {
+            while (tryPop([](T&&) {}));
+        }
+
+        /*
+        * Returns false without enqueueing if the queue was cancelled while waiting for room.
+        */
+        bool push(T&& value) {
+            const std::size_t t = tail.load(std::memory_order_relaxed);
+            const std::size_t next = (t + 1) % slotCount;
+            waitUntil(producerParked, [&]() {
+                return next != head.load(std::memory_order_acquire) || cancelled.load(std::memory_order_relaxed);
+            });
+            if (next == head.load(std::memory_order_acquire)) {
+                return false;
+            }
+            new (&slots[t]) T(std::move(value));
+            tail.store(next, std::memory_order_release);
+            wake(consumerParked);
+            return true;
+        }
+
+        /*
+        * Blocks until a value is available and hands it to the consumer.
+        * Returns false once the queue is closed and drained, or cancelled.
+        */
+        template <typename Consumer>
+        bool pop(Consumer&& consumer) {
+            for (;;) {
+                if (tryPop(consumer)) {
+                    return true;
+                }
+                if (cancelled.load(std::memory_order_relaxed)) {
+                    return false;
+                }
+                if (closed.load(std::memory_order_acquire)) {
+                    // The producer may have pushed right before closing
+                    return tryPop(consumer);
+                }
+                waitUntil(consumerParked, [&]() {
+                    return head.load(std::memory_order_relaxed) != tail.load(std::memory_order_acquire)
+                        || closed.load(std::memory_order_acquire) || cancelled.load(std::memory_order_relaxed);
+                });
+            }
+        }
+
+        /*
+        * Called by the producer once it will push no more values.
+        */
+        void close() {
+            closed.store(true, std::memory_order_release);
+            wakeAll();
+        }
+
+        /*
+        * Wakes both sides up for good, dropping whatever is still queued.
+        */
+        void cancel() {
+            cancelled.store(true, std::memory_order_relaxed);
+            wakeAll();
+        }
+
+    private:
+        typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+        static const int spinLimit = 64;
+
+        static std::size_t checkCapacity(const std::size_t capacity) {
+            if (capacity == 0) {
+                throw IllegalSizeError {"Queue capacity must be at least 1"};
+            }
+            return capacity;
+        }
+
+        /*
+        * The parked flag is published before the final check of ready(), and wake() checks the flag after
+        * publishing its own update, with a full fence on both sides. So either the waiter sees the update,
+        * or the waker sees the flag and notifies under the mutex once the waiter is actually waiting.
+        */
+        template <typename Ready>
+        void waitUntil(std::atomic<bool>& parked, Ready ready) {
+            for (int i = 0; i < spinLimit; i++) {
+                if (ready()) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+            std::unique_lock<std::mutex> lock(parkMutex);
+            parked.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            while (!ready()) {
+                parkCondition.wait(lock);
+            }
+            parked.store(false, std::memory_order_relaxed);
+        }
+
+        void wake(std::atomic<bool>& parked) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (parked.load(std::memory_order_relaxed)) {
+                wakeAll();
+            }
+        }
+
+        void wakeAll() {
+            {
+                std::lock_guard<std::mutex> lock(parkMutex);
+            }
+            parkCondition.notify_all();
+        }
+
+        template <typename Consumer>
+        bool tryPop(Consumer&& consumer) {
+            const std::size_t h = head.load(std::memory_order_relaxed);
+            if (h == tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+            T* slot = reinterpret_cast<T*>(&slots[h]);
+            consumer(std::move(*slot));
+            slot -> ~T();
+            head.store((h + 1) % slotCount, std::memory_order_release);
+            wake(producerParked);
+            return true;
+        }
+
+        const std::size_t slotCount;
+        const std::unique_ptr<Slot[]> slots;
+
+        alignas(64) std::atomic<std::size_t> head;
+        alignas(64) std::atomic<std::size_t> tail;
+        std::atomic<bool> closed, cancelled;
+
+        std::atomic<bool> producerParked, consumerParked;
+        std::mutex parkMutex;
+        std::condition_variable parkCondition;
+    };
+}
+
+#endif //DT1_SPSC_QUEUE_H
@@ -0,0 +1,112 @@
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "../rp/sharded_grid.hpp"
+
+namespace {
+    int failures = 0;
+
+    void check(const bool condition, const std::string& description) {
+        if (!condition) {
+            std::cout << "FAILED: " << description << "\n";
+            failures++;
+        }
+    }
+
+    struct StoredRect {
+        std::string name;
+        int x1, y1, x2, y2;
+    };
+
+    int countIntersecting(const RP::ShardedGrid<int>& grid, RP::Rectangle<int>&& region) {
+        int count = 0;
+        grid.forEachIntersecting(region, [&count](const RP::Rectangle<int>&) { count++; });
+        return count;
+    }
+}
+
+int main() {
+    std::map<RP::ShardedGrid<int>::size_type, std::vector<StoredRect>> store;
+    bool failReads = false;
+
+    RP::ShardedGrid<int> grid{400, 600, 100, 100,
+        [&store](const RP::ShardedGrid<int>::size_type shard, const RP::Grid<int>& g) {
+            auto& rects = store[shard];
+            rects.clear();
+            g.forEach([&rects](const RP::Rectangle<int>& r) {
+                rects.push_back({r.name, r.bottomLeft.x, r.bottomLeft.y, r.topRight.x, r.topRight.y});
+            });
+        },
+        [&store, &failReads](const RP::ShardedGrid<int>::size_type shard, RP::Grid<int>& g) {
+            if (failReads) {
+                throw RP::ShardStateError {"Shard " + std::to_string(shard) + " is unreadable"};
+            }
+            for (const auto& r : store[shard]) {
+                g.addRectangle(RP::Rectangle<int> {{r.x1, r.y1}, {r.x2, r.y2}, std::string(r.name)});
+            }
+        }};
+
+    check(grid.shardCount() == 24, "a 600x400 grid with 100x100 tiles has 24 shards");
+
+    // "abcd" straddles shards 1 and 2
+    grid.addRectangle(RP::Rectangle<int> {{150, 50}, {250, 60}, "abcd"});
+    grid.addRectangle(RP::Rectangle<int> {{10, 10}, {20, 20}, "efgh"});
+    check(grid.size() == 2, "both rectangles are added");
+
+    try {
+        grid.addRectangle(RP::Rectangle<int> {{300, 300}, {310, 310}, "efgh"});
+        check(false, "duplicate names are rejected");
+    } catch (const RP::IllegalNameError&) {}
+
+    try {
+        grid.addRectangle(RP::Rectangle<int> {{10, 10}, {700, 20}, "wide"});
+        check(false, "rectangles wider than the grid are rejected");
+    } catch (const RP::IllegalSizeError&) {}
+
+    int visited = 0;
+    grid.forEach([&visited](const RP::Rectangle<int>&) { visited++; });
+    check(visited == 2, "forEach visits a straddling rectangle once");
+    check(countIntersecting(grid, RP::Rectangle<int> {{0, 0}, {600, 400}, "all"}) == 2, "a region query visits a straddling rectangle once");
+    check(countIntersecting(grid, RP::Rectangle<int> {{220, 0}, {230, 99}, "right"}) == 1, "a straddling rectangle is found from its second shard");
+
+    int containing = 0;
+    grid.forEachContainingPoint({220, 55}, [&containing](const RP::Rectangle<int>&) { containing++; });
+    check(containing == 1, "a point query finds the straddling rectangle");
+
+    grid.unloadShard(1);
+    grid.unloadShard(2);
+    check(!grid.isShardLoaded(1) && !grid.isShardLoaded(2), "shards can be unloaded");
+
+    visited = 0;
+    grid.forEach([&visited](const RP::Rectangle<int>&) { visited++; });
+    check(visited == 2, "unloaded shards are still scanned");
+    check(!grid.isShardLoaded(1) && !grid.isShardLoaded(2), "a default scan does not keep reloaded shards resident");
+
+    grid.forEach([](const RP::Rectangle<int>&) {}, RP::ShardedGrid<int>::ScanMode::KeepLoaded);
+    check(grid.isShardLoaded(1) && grid.isShardLoaded(2), "a KeepLoaded scan keeps reloaded shards resident");
+
+    grid.unloadShard(2);
+    failReads = true;
+    try {
+        // Straddles shards 1 and 2; shard 2 cannot be read back
+        grid.addRectangle(RP::Rectangle<int> {{160, 70}, {260, 80}, "ijkl"});
+        check(false, "an unreadable shard fails the insert");
+    } catch (const RP::ShardStateError&) {}
+    failReads = false;
+    check(grid.size() == 2 && !grid.findRectangleByName("ijkl"), "a failed insert is not visible");
+    grid.addRectangle(RP::Rectangle<int> {{160, 70}, {260, 80}, "ijkl"});
+    check(grid.size() == 3, "a name can be reused after a failed insert");
+
+    check(static_cast<bool>(grid.findRectangleByName("abcd")), "a rectangle is found by name after its shards were reloaded");
+    check(grid.removeRectangleByName("abcd"), "a straddling rectangle can be removed");
+    check(!grid.removeRectangleByName("abcd"), "a removed rectangle cannot be removed twice");
+    check(countIntersecting(grid, RP::Rectangle<int> {{220, 50}, {230, 60}, "right"}) == 0, "no copy of a removed rectangle is left behind");
+    check(grid.size() == 2, "size reflects the removal");
+
+    if (failures) {
+        return 1;
+    }
+    std::cout << "All ShardedGrid checks passed.\n";
+    return 0;
+}